@@ -7,6 +7,7 @@ from tkinter import *
 from tkinter import ttk
 import time
 import serial
+import struct
 import threading
 
 ApplicationGL = False
@@ -18,6 +19,15 @@ class PortSettings:
     Timeout = 2
 
 
+class Protocol:
+    Sync = 0xA5
+    CmdSubscribe = 0x01
+    FrameAttitude = 0x90
+    FrameStateEvent = 0x92
+    SubscribeRetry = 1.0
+    StreamAttitude = 0
+
+
 class IMU:
     Roll = 0
     Pitch = 0
@@ -118,25 +128,79 @@ def DrawGL():
     pygame.display.flip()
 
 
+def SendFrame(frameId, payload):
+    checksum = frameId ^ len(payload)
+    for data in payload:
+        checksum ^= data
+    serial_object.write(bytes([Protocol.Sync, frameId, len(payload)]) + bytes(payload) + bytes([checksum]))
+
+
 def SerialConnection():
     global serial_object
     serial_object = serial.Serial(
         myport.Name, baudrate=myport.Speed, timeout=myport.Timeout)
 
 
+def SubscribeAttitude():
+    SendFrame(Protocol.CmdSubscribe, [1 << Protocol.StreamAttitude])
+
+
+def ReadFrame():
+    # Frame: [0xA5] [id] [len] [payload] [XOR of id, len and payload]
+    while True:
+        sync = serial_object.read(1)
+        if len(sync) == 0:
+            return None
+        if sync[0] == Protocol.Sync:
+            break
+
+    header = serial_object.read(2)
+    if len(header) != 2:
+        return None
+    frameId, length = header[0], header[1]
+
+    payload = serial_object.read(length)
+    checksum = serial_object.read(1)
+    if len(payload) != length or len(checksum) != 1:
+        return None
+
+    expected = frameId ^ length
+    for data in payload:
+        expected ^= data
+    if expected != checksum[0]:
+        return None
+
+    return frameId, payload
+
+
 def ReadData():
+    # Opening the port resets the board and a reset drops the subscription, so keep subscribing until attitude
+    # frames arrive and again whenever they stop
+    lastAttitude = 0
+    lastSubscribe = 0
+
     while True:
 
-        serial_input = serial_object.readline()
-        if(len(serial_input) == 11 and serial_input[0] == 0x24):
-            X = [serial_input[4], serial_input[3], serial_input[2], serial_input[1]]
-            Ax = int.from_bytes(X, byteorder='big', signed=True)
+        now = time.monotonic()
+        if now - lastAttitude > Protocol.SubscribeRetry and now - lastSubscribe > Protocol.SubscribeRetry:
+            SubscribeAttitude()
+            lastSubscribe = now
+
+        frame = ReadFrame()
+        if frame is None:
+            continue
+
+        if frame[0] == Protocol.FrameStateEvent:
+            # Sent on boot and on every state change, the board listens now, subscribing again is harmless
+            SubscribeAttitude()
+            lastSubscribe = time.monotonic()
 
-            Y = [serial_input[8], serial_input[7], serial_input[6], serial_input[5]]
-            Ay = int.from_bytes(Y, byteorder='big', signed=True)
+        if frame[0] == Protocol.FrameAttitude and len(frame[1]) == 8:
+            lastAttitude = time.monotonic()
+            roll, pitch = struct.unpack('<ff', frame[1])
 
-            myimu.Roll = Ay
-            myimu.Pitch = Ax
+            myimu.Roll = pitch
+            myimu.Pitch = roll
 
 
 def main():
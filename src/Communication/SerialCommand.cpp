@@ -0,0 +1,520 @@
+/**
+ * {
+ * \file       SerialCommand.cpp
+ * \brief      Binary command protocol over UART to select the streams and tune the parameters at runtime
+ * \copyright  (C) 2022 Cerberus team
+ *             The reproduction, distribution and utilization of this file as
+ *             well as the communication of its contents to others without express
+ *             authorization is prohibited. Offenders will be held liable for the
+ *             payment of damages. All rights reserved in the event of the grant
+ *             of a patent, utility model or design.
+ * }
+ */
+
+/***********************************************************************************************************************
+ **                                                      INCLUDES                                                     **
+ **********************************************************************************************************************/
+
+#include <Arduino.h>
+#include <string.h>
+#include "SerialCommand.h"
+#include "Configure/Cfg.h"
+#include "Configure/Parameter.h"
+#include "DataControl/DataControl.h"
+#include "StateMachine/MainState.h"
+
+/***********************************************************************************************************************
+ **                                                   DEFINES/MACROS                                                  **
+ **********************************************************************************************************************/
+
+#define FRAME_SYNC              (0xA5)
+
+#define CMD_SUBSCRIBE           (0x01)
+#define CMD_UNSUBSCRIBE         (0x02)
+#define CMD_SET_DECIMATION      (0x03)
+#define CMD_SET_PARAM           (0x04)
+#define CMD_GET_PARAM           (0x05)
+#define CMD_COMMIT_PARAM        (0x06)
+
+#define FRAME_ACK               (0x80)
+#define FRAME_PARAM             (0x81)
+#define FRAME_ATTITUDE          (0x90)
+#define FRAME_RAW_IMU           (0x91)
+#define FRAME_STATE_EVENT       (0x92)
+#define FRAME_PROFILER          (0x93)
+
+#define STATUS_OK               (0x00)
+#define STATUS_BAD_CHECKSUM     (0x01)
+#define STATUS_BAD_LENGTH       (0x02)
+#define STATUS_BAD_VALUE        (0x03)
+#define STATUS_UNKNOWN_COMMAND  (0x04)
+
+#define DEFAULT_STREAM_MASK     (1 << E_StreamStateEvent)
+#define VALID_STREAM_MASK       ((1 << E_StreamCount) - 1)
+
+extern DataControl dataController;
+
+/***********************************************************************************************************************
+ **                                           INTERNAL FUNCTION DECLARATIONS                                          **
+ **********************************************************************************************************************/
+
+static void ParseByte(uint8_t data);
+static void ExecuteCommand(void);
+static uint8_t HandleSubscribe(uint8_t *enabled);
+static uint8_t HandleUnsubscribe(void);
+static uint8_t HandleSetDecimation(void);
+static uint8_t HandleSetParam(void);
+static uint8_t HandleGetParam(bool *replied);
+static void SendFrame(uint8_t id, const uint8_t *payload, uint8_t len);
+static void SendAck(uint8_t command, uint8_t status);
+static bool IsStreamDue(uint8_t stream);
+static void OnStreamsEnabled(uint8_t enabled);
+static void ResetProfiler(void);
+static void PublishAttitude(void);
+static void PublishRawImu(void);
+static void PublishProfiler(void);
+
+/***********************************************************************************************************************
+ **                                                 INTERNAL VARIABLES                                                **
+ **********************************************************************************************************************/
+
+enum {
+    E_RxWaitSync,
+    E_RxId,
+    E_RxLength,
+    E_RxPayload,
+    E_RxChecksum
+};
+
+static uint8_t rxState = E_RxWaitSync;
+static uint8_t rxId;
+static uint8_t rxLength;
+static uint8_t rxIndex;
+static uint8_t rxChecksum;
+static uint8_t rxPayload[CMD_MAX_PAYLOAD];
+static uint16_t rxErrors;
+
+static uint8_t streamMask = DEFAULT_STREAM_MASK;
+static uint8_t decimation[E_StreamCount];
+static uint8_t decimationCounter[E_StreamCount];
+
+static unsigned long profLastUs;
+static unsigned long profMaxUs;
+static unsigned long profSumUs;
+static uint32_t profCount;
+
+/***********************************************************************************************************************
+ **                                                FUNCTION DEFINITIONS                                               **
+ **********************************************************************************************************************/
+
+void SerialCommand_Initialize()
+{
+    for (uint8_t i = 0; i < E_StreamCount; i++)
+    {
+        decimation[i] = 1;
+        decimationCounter[i] = 0;
+    }
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief Consume the bytes already in the RX buffer and execute every complete command. Never wait for more data, a
+ *        frame split across several calls is continued on the next call.
+ **********************************************************************************************************************/
+void SerialCommand_ProcessRx()
+{
+    int pending = Serial.available();
+
+    while (pending-- > 0)
+    {
+        ParseByte((uint8_t)Serial.read());
+    }
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief Send the subscribed periodic streams, called once per control step
+ **********************************************************************************************************************/
+void SerialCommand_PublishStreams()
+{
+    if (IsStreamDue(E_StreamAttitude))
+    {
+        PublishAttitude();
+    }
+
+    if (IsStreamDue(E_StreamRawImu))
+    {
+        PublishRawImu();
+    }
+
+    if (IsStreamDue(E_StreamProfiler))
+    {
+        PublishProfiler();
+    }
+}
+
+void SerialCommand_SendStateEvent(uint8_t state)
+{
+    if (streamMask & (1 << E_StreamStateEvent))
+    {
+        SendFrame(FRAME_STATE_EVENT, &state, sizeof(state));
+    }
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief Accumulate the execution time of one control step while the profiler stream is subscribed, the statistic is
+ *        reset each time it is published
+ *
+ * \param [in] execTimeUs - Duration of the step in microseconds
+ **********************************************************************************************************************/
+void SerialCommand_UpdateProfiler(unsigned long execTimeUs)
+{
+    if (!(streamMask & (1 << E_StreamProfiler)))
+    {
+        return;
+    }
+
+    profLastUs = execTimeUs;
+    profSumUs += execTimeUs;
+    profCount++;
+
+    if (execTimeUs > profMaxUs)
+    {
+        profMaxUs = execTimeUs;
+    }
+}
+
+/**********************************************************************************************************************/
+/* Receive */
+
+static void ParseByte(uint8_t data)
+{
+    switch (rxState)
+    {
+    case E_RxWaitSync:
+        if (data == FRAME_SYNC)
+        {
+            rxState = E_RxId;
+        }
+        break;
+
+    case E_RxId:
+        rxId = data;
+        rxChecksum = data;
+        rxState = E_RxLength;
+        break;
+
+    case E_RxLength:
+        if (data > CMD_MAX_PAYLOAD)
+        {
+            rxErrors++;
+            SendAck(rxId, STATUS_BAD_LENGTH);
+            rxState = E_RxWaitSync;
+            break;
+        }
+        rxLength = data;
+        rxIndex = 0;
+        rxChecksum ^= data;
+        rxState = (rxLength == 0) ? E_RxChecksum : E_RxPayload;
+        break;
+
+    case E_RxPayload:
+        rxPayload[rxIndex++] = data;
+        rxChecksum ^= data;
+        if (rxIndex >= rxLength)
+        {
+            rxState = E_RxChecksum;
+        }
+        break;
+
+    case E_RxChecksum:
+        if (data == rxChecksum)
+        {
+            ExecuteCommand();
+        }
+        else
+        {
+            rxErrors++;
+            SendAck(rxId, STATUS_BAD_CHECKSUM);
+        }
+        rxState = E_RxWaitSync;
+        break;
+
+    default:
+        rxState = E_RxWaitSync;
+        break;
+    }
+}
+
+static void ExecuteCommand(void)
+{
+    uint8_t status = STATUS_OK;
+    uint8_t enabled = 0;
+    bool replied = false;
+
+    switch (rxId)
+    {
+    case CMD_SUBSCRIBE:
+        status = HandleSubscribe(&enabled);
+        break;
+
+    case CMD_UNSUBSCRIBE:
+        status = HandleUnsubscribe();
+        break;
+
+    case CMD_SET_DECIMATION:
+        status = HandleSetDecimation();
+        break;
+
+    case CMD_SET_PARAM:
+        status = HandleSetParam();
+        break;
+
+    case CMD_GET_PARAM:
+        status = HandleGetParam(&replied);
+        break;
+
+    case CMD_COMMIT_PARAM:
+        if (rxLength != 0)
+        {
+            status = STATUS_BAD_LENGTH;
+            break;
+        }
+        Parameter_Commit();
+        break;
+
+    default:
+        status = STATUS_UNKNOWN_COMMAND;
+        break;
+    }
+
+    if (!replied)
+    {
+        SendAck(rxId, status);
+    }
+    OnStreamsEnabled(enabled);
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief Add the streams of the mask to the subscription
+ *
+ * \param [out] enabled - Streams that were off before this command
+ **********************************************************************************************************************/
+static uint8_t HandleSubscribe(uint8_t *enabled)
+{
+    if (rxLength != 1)
+    {
+        return STATUS_BAD_LENGTH;
+    }
+
+    if (rxPayload[0] & ~VALID_STREAM_MASK)
+    {
+        return STATUS_BAD_VALUE;
+    }
+
+    *enabled = rxPayload[0] & ~streamMask;
+    streamMask |= rxPayload[0];
+    return STATUS_OK;
+}
+
+static uint8_t HandleUnsubscribe(void)
+{
+    if (rxLength != 1)
+    {
+        return STATUS_BAD_LENGTH;
+    }
+
+    if (rxPayload[0] & ~VALID_STREAM_MASK)
+    {
+        return STATUS_BAD_VALUE;
+    }
+
+    streamMask &= ~rxPayload[0];
+    return STATUS_OK;
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief The state event stream is sent on change only, so it has no decimation
+ **********************************************************************************************************************/
+static uint8_t HandleSetDecimation(void)
+{
+    if (rxLength != 2)
+    {
+        return STATUS_BAD_LENGTH;
+    }
+
+    uint8_t stream = rxPayload[0];
+    uint8_t divider = rxPayload[1];
+
+    if (stream >= E_StreamCount || stream == E_StreamStateEvent || divider == 0)
+    {
+        return STATUS_BAD_VALUE;
+    }
+
+    decimation[stream] = divider;
+    decimationCounter[stream] = 0;
+    return STATUS_OK;
+}
+
+static uint8_t HandleSetParam(void)
+{
+    float value;
+
+    if (rxLength != 1 + sizeof(value))
+    {
+        return STATUS_BAD_LENGTH;
+    }
+
+    memcpy(&value, &rxPayload[1], sizeof(value));
+
+    return Parameter_Set(rxPayload[0], value) ? STATUS_OK : STATUS_BAD_VALUE;
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief A valid request is answered by a Param frame instead of an ACK
+ *
+ * \param [out] replied - True if the Param frame was sent
+ **********************************************************************************************************************/
+static uint8_t HandleGetParam(bool *replied)
+{
+    uint8_t frame[1 + sizeof(float)];
+    float value;
+
+    if (rxLength != 1)
+    {
+        return STATUS_BAD_LENGTH;
+    }
+
+    if (!Parameter_Get(rxPayload[0], &value))
+    {
+        return STATUS_BAD_VALUE;
+    }
+
+    frame[0] = rxPayload[0];
+    memcpy(&frame[1], &value, sizeof(value));
+    SendFrame(FRAME_PARAM, frame, sizeof(frame));
+    *replied = true;
+    return STATUS_OK;
+}
+
+/**********************************************************************************************************************/
+/* Transmit */
+
+static void SendFrame(uint8_t id, const uint8_t *payload, uint8_t len)
+{
+    uint8_t header[3] = {FRAME_SYNC, id, len};
+    uint8_t checksum = id ^ len;
+
+    for (uint8_t i = 0; i < len; i++)
+    {
+        checksum ^= payload[i];
+    }
+
+    Serial.write(header, sizeof(header));
+    Serial.write(payload, len);
+    Serial.write(checksum);
+}
+
+static void SendAck(uint8_t command, uint8_t status)
+{
+    uint8_t payload[2] = {command, status};
+
+    SendFrame(FRAME_ACK, payload, sizeof(payload));
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief Check the subscription and advance the decimation counter of a periodic stream
+ *
+ * \return True if the stream has to be sent in this step
+ **********************************************************************************************************************/
+static bool IsStreamDue(uint8_t stream)
+{
+    if (!(streamMask & (1 << stream)))
+    {
+        return false;
+    }
+
+    if (++decimationCounter[stream] < decimation[stream])
+    {
+        return false;
+    }
+
+    decimationCounter[stream] = 0;
+    return true;
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief Start the newly subscribed streams from a clean point: the profiler window begins now and the host learns the
+ *        current state without waiting for the next transition
+ **********************************************************************************************************************/
+static void OnStreamsEnabled(uint8_t enabled)
+{
+    for (uint8_t i = 0; i < E_StreamCount; i++)
+    {
+        if (enabled & (1 << i))
+        {
+            decimationCounter[i] = 0;
+        }
+    }
+
+    if (enabled & (1 << E_StreamProfiler))
+    {
+        ResetProfiler();
+    }
+
+    if (enabled & (1 << E_StreamStateEvent))
+    {
+        uint8_t state = StateMachine_GetState();
+
+        if (state != E_Unknown)
+        {
+            SendFrame(FRAME_STATE_EVENT, &state, sizeof(state));
+        }
+    }
+}
+
+static void PublishAttitude(void)
+{
+    float attitude[2] = {dataController.GetRoll(), dataController.GetPitch()};
+
+    SendFrame(FRAME_ATTITUDE, (const uint8_t *)attitude, sizeof(attitude));
+}
+
+static void PublishRawImu(void)
+{
+    int16_t raw[6];
+
+    dataController.GetRawImu(raw);
+    SendFrame(FRAME_RAW_IMU, (const uint8_t *)raw, sizeof(raw));
+}
+
+static void PublishProfiler(void)
+{
+    uint8_t frame[3 * sizeof(uint32_t) + sizeof(uint16_t)];
+    uint32_t lastUs = profLastUs;
+    uint32_t maxUs = profMaxUs;
+    uint32_t avgUs = (profCount > 0) ? (profSumUs / profCount) : 0;
+
+    memcpy(&frame[0], &lastUs, sizeof(lastUs));
+    memcpy(&frame[4], &maxUs, sizeof(maxUs));
+    memcpy(&frame[8], &avgUs, sizeof(avgUs));
+    memcpy(&frame[12], &rxErrors, sizeof(rxErrors));
+    SendFrame(FRAME_PROFILER, frame, sizeof(frame));
+
+    ResetProfiler();
+}
+
+static void ResetProfiler(void)
+{
+    profMaxUs = 0;
+    profSumUs = 0;
+    profCount = 0;
+}
+
+/**********************************************************************************************************************/
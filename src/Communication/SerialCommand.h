@@ -0,0 +1,53 @@
+/**
+ * {
+ * \file       SerialCommand.h
+ * \brief      Binary command protocol over UART to select the streams and tune the parameters at runtime
+ * \copyright  (C) 2022 Cerberus team
+ *             The reproduction, distribution and utilization of this file as
+ *             well as the communication of its contents to others without express
+ *             authorization is prohibited. Offenders will be held liable for the
+ *             payment of damages. All rights reserved in the event of the grant
+ *             of a patent, utility model or design.
+ * }
+ *
+ * Every frame, in both directions, has the same layout:
+ *   [0xA5] [id] [len] [payload: len bytes] [checksum: XOR of id, len and payload]
+ * Multi-byte fields are little endian, float is IEEE-754 single precision.
+ *
+ * Commands (PC -> device), each one is answered with an ACK frame:
+ *   0x01 Subscribe        [streamMask]          Enable the streams of the mask, bit n is stream E_Stream* n
+ *   0x02 Unsubscribe      [streamMask]          Disable the streams of the mask
+ *   0x03 SetDecimation    [streamId][divider]   Send a periodic stream once every <divider> control steps
+ *   0x04 SetParam         [paramId][float]      Change a parameter in RAM, see Parameter.h
+ *   0x05 GetParam         [paramId]             Answered by a Param frame instead of an ACK
+ *   0x06 CommitParam      []                    Store the current parameters to EEPROM
+ *
+ * Frames (device -> PC):
+ *   0x80 Ack              [commandId][status]
+ *   0x81 Param            [paramId][float]
+ *   0x90 Attitude         [roll][pitch]         float, degree
+ *   0x91 RawImu           [accX][accY][accZ][gyroX][gyroY][gyroZ]  int16 raw register values
+ *   0x92 StateEvent       [state]               Sent on subscribe and on every state change, never decimated
+ *   0x93 Profiler         [lastUs][maxUs][avgUs] uint32, [rxErrors] uint16
+ */
+
+#ifndef __SERIAL_COMMAND__
+#define __SERIAL_COMMAND__
+
+#include <Arduino.h>
+
+enum {
+    E_StreamAttitude,
+    E_StreamRawImu,
+    E_StreamStateEvent,
+    E_StreamProfiler,
+    E_StreamCount
+};
+
+void SerialCommand_Initialize();
+void SerialCommand_ProcessRx();
+void SerialCommand_PublishStreams();
+void SerialCommand_SendStateEvent(uint8_t state);
+void SerialCommand_UpdateProfiler(unsigned long execTimeUs);
+
+#endif
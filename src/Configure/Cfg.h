@@ -17,11 +17,16 @@
 /* Feature switch */
 #define MONITOR_DATA_TO_PC
 
-/* Configure for feature */
+/* Configure for feature, TURN_ANGLE/BACK_TO_NORMAL_TIME/FILTER_ALPHA are only defaults, see Parameter.h */
 #define DELAY_TIME              (100)
 #define BACK_TO_NORMAL_TIME     (3000)
 #define ALIVE_LED_TIME          (500)
 #define TURN_ANGLE              (20)
+#define FILTER_ALPHA            (0.94f)
+
+/* Serial control plane */
+#define CMD_MAX_PAYLOAD         (8)
+#define PARAM_EEPROM_ADDRESS    (0)
 
 /* Hardware pin */
 #define ALIVE_LED_PIN           (9)
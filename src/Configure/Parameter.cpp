@@ -0,0 +1,200 @@
+/**
+ * {
+ * \file       Parameter.cpp
+ * \brief      Runtime tunable parameters, backed by EEPROM
+ * \copyright  (C) 2022 Cerberus team
+ *             The reproduction, distribution and utilization of this file as
+ *             well as the communication of its contents to others without express
+ *             authorization is prohibited. Offenders will be held liable for the
+ *             payment of damages. All rights reserved in the event of the grant
+ *             of a patent, utility model or design.
+ * }
+ */
+
+/***********************************************************************************************************************
+ **                                                      INCLUDES                                                     **
+ **********************************************************************************************************************/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stddef.h>
+#include "Parameter.h"
+#include "Configure/Cfg.h"
+
+/***********************************************************************************************************************
+ **                                                   DEFINES/MACROS                                                  **
+ **********************************************************************************************************************/
+
+#define PARAM_MAGIC             (0x5443)    ///< Marks an EEPROM image written by this firmware
+#define PARAM_VERSION           (1)         ///< Increase on every change of ParamImage
+
+/***********************************************************************************************************************
+ **                                                 INTERNAL VARIABLES                                                **
+ **********************************************************************************************************************/
+
+typedef struct
+{
+    uint16_t magic;
+    uint8_t version;
+    uint8_t size;
+    float turnAngle;
+    uint32_t backToNormalTime;
+    float filterAlpha;
+    uint8_t checksum;
+} ParamImage;
+
+static ParamImage param;
+
+/***********************************************************************************************************************
+ **                                           INTERNAL FUNCTION DECLARATIONS                                          **
+ **********************************************************************************************************************/
+
+static uint8_t CalcChecksum(const ParamImage *image);
+static void LoadDefault(void);
+
+/***********************************************************************************************************************
+ **                                                FUNCTION DEFINITIONS                                               **
+ **********************************************************************************************************************/
+
+/**
+ ***********************************************************************************************************************
+ * \brief Load the parameters from EEPROM, fall back to the values of Cfg.h if the stored image is missing, corrupted
+ *        or written with another layout
+ **********************************************************************************************************************/
+void Parameter_Initialize()
+{
+    EEPROM.get(PARAM_EEPROM_ADDRESS, param);
+
+    if (param.magic != PARAM_MAGIC || param.version != PARAM_VERSION || param.size != sizeof(ParamImage) ||
+        param.checksum != CalcChecksum(&param))
+    {
+        LoadDefault();
+        return;
+    }
+
+    /* Re-validate, the image may come from an older build with other limits */
+    if (!Parameter_Set(E_ParamTurnAngle, param.turnAngle) ||
+        !Parameter_Set(E_ParamBackToNormalTime, (float)param.backToNormalTime) ||
+        !Parameter_Set(E_ParamFilterAlpha, param.filterAlpha))
+    {
+        LoadDefault();
+    }
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief Change one parameter in RAM. The change is lost on reset unless Parameter_Commit() is called.
+ *
+ * \param [in] id    - Parameter id, see E_Param*
+ * \param [in] value - New value, in the unit of the parameter (degree, millisecond, ratio)
+ *
+ * \return True if the id is known and the value is in range
+ **********************************************************************************************************************/
+bool Parameter_Set(uint8_t id, float value)
+{
+    /* Written as positive ranges so that a NaN coming from the wire is rejected too */
+    switch (id)
+    {
+    case E_ParamTurnAngle:
+        if (!(value > 0.0f && value < 90.0f))
+        {
+            return false;
+        }
+        param.turnAngle = value;
+        return true;
+
+    case E_ParamBackToNormalTime:
+        if (!(value >= 0.0f && value <= 60000.0f))
+        {
+            return false;
+        }
+        param.backToNormalTime = (uint32_t)value;
+        return true;
+
+    case E_ParamFilterAlpha:
+        if (!(value >= 0.0f && value < 1.0f))
+        {
+            return false;
+        }
+        param.filterAlpha = value;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+bool Parameter_Get(uint8_t id, float *value)
+{
+    switch (id)
+    {
+    case E_ParamTurnAngle:
+        *value = param.turnAngle;
+        return true;
+
+    case E_ParamBackToNormalTime:
+        *value = (float)param.backToNormalTime;
+        return true;
+
+    case E_ParamFilterAlpha:
+        *value = param.filterAlpha;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief Store the current parameters to EEPROM. EEPROM.put() only rewrites the bytes that changed.
+ **********************************************************************************************************************/
+void Parameter_Commit()
+{
+    param.magic = PARAM_MAGIC;
+    param.version = PARAM_VERSION;
+    param.size = sizeof(ParamImage);
+    param.checksum = CalcChecksum(&param);
+    EEPROM.put(PARAM_EEPROM_ADDRESS, param);
+}
+
+float Parameter_GetTurnAngle()
+{
+    return param.turnAngle;
+}
+
+unsigned long Parameter_GetBackToNormalTime()
+{
+    return param.backToNormalTime;
+}
+
+float Parameter_GetFilterAlpha()
+{
+    return param.filterAlpha;
+}
+
+static void LoadDefault(void)
+{
+    param.turnAngle = (float)TURN_ANGLE;
+    param.backToNormalTime = BACK_TO_NORMAL_TIME;
+    param.filterAlpha = FILTER_ALPHA;
+}
+
+/**
+ ***********************************************************************************************************************
+ * \brief XOR of every byte of the image except the checksum itself
+ **********************************************************************************************************************/
+static uint8_t CalcChecksum(const ParamImage *image)
+{
+    const uint8_t *bytes = (const uint8_t *)image;
+    uint8_t checksum = 0;
+
+    for (uint8_t i = 0; i < offsetof(ParamImage, checksum); i++)
+    {
+        checksum ^= bytes[i];
+    }
+
+    return checksum;
+}
+
+/**********************************************************************************************************************/
@@ -0,0 +1,35 @@
+/**
+ * {
+ * \file       Parameter.h
+ * \brief      Runtime tunable parameters, backed by EEPROM
+ * \copyright  (C) 2022 Cerberus team
+ *             The reproduction, distribution and utilization of this file as
+ *             well as the communication of its contents to others without express
+ *             authorization is prohibited. Offenders will be held liable for the
+ *             payment of damages. All rights reserved in the event of the grant
+ *             of a patent, utility model or design.
+ * }
+ */
+
+#ifndef __PARAMETER__
+#define __PARAMETER__
+
+#include <Arduino.h>
+
+enum {
+    E_ParamTurnAngle,
+    E_ParamBackToNormalTime,
+    E_ParamFilterAlpha,
+    E_ParamCount
+};
+
+void Parameter_Initialize();
+bool Parameter_Set(uint8_t id, float value);
+bool Parameter_Get(uint8_t id, float *value);
+void Parameter_Commit();
+
+float Parameter_GetTurnAngle();
+unsigned long Parameter_GetBackToNormalTime();
+float Parameter_GetFilterAlpha();
+
+#endif
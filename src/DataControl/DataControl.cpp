@@ -16,6 +16,7 @@
  **********************************************************************************************************************/
 
 #include "Configure/Cfg.h"
+#include "Configure/Parameter.h"
 #include <MPU6050_tockn.h>
 #include <Adafruit_SSD1306.h>
 #include <Wire.h>
@@ -78,7 +79,7 @@ void DataControl::InitPeripheral()
 
     Wire.begin();
     this->mpu6050->begin();
-    this->mpu6050->calcGyroOffsets(true, 1000, 1000);
+    this->mpu6050->calcGyroOffsets(false, 1000, 1000);
 
     pinMode(SIGNAL_RIGHT_PIN, INPUT);
     pinMode(SIGNAL_LEFT_PIN, INPUT);
@@ -171,14 +172,15 @@ void DataControl::UpdateRollPitch()
     float RawAccZ = (float)this->mpu6050->getAccZ();
     float rawRoll;
     float rawPitch;
+    float alpha = Parameter_GetFilterAlpha();
 
     // Calculate Roll and Pitch (rotation around X-axis, rotation around Y-axis)
     rawRoll = atan(RawAccY / sqrt(pow(RawAccX, 2) + pow(RawAccZ, 2))) * 180 / PI;
     rawPitch = atan(-1 * RawAccX / sqrt(pow(RawAccY, 2) + pow(RawAccZ, 2))) * 180 / PI;
 
     // Low-pass filter
-    this->roll = 0.94 * this->roll + 0.06 * rawRoll;
-    this->pitch = 0.94 * this->pitch + 0.06 * rawPitch;
+    this->roll = alpha * this->roll + (1.0f - alpha) * rawRoll;
+    this->pitch = alpha * this->pitch + (1.0f - alpha) * rawPitch;
 }
 
 float DataControl::GetRoll()
@@ -190,3 +192,19 @@ float DataControl::GetPitch()
 {
     return this->pitch;
 }
+
+/**
+ ***********************************************************************************************************************
+ * \brief Copy the last raw register values read from MPU6050
+ *
+ * \param [out] raw - Array of 6 elements: AccX, AccY, AccZ, GyroX, GyroY, GyroZ
+ **********************************************************************************************************************/
+void DataControl::GetRawImu(int16_t *raw)
+{
+    raw[0] = this->mpu6050->getRawAccX();
+    raw[1] = this->mpu6050->getRawAccY();
+    raw[2] = this->mpu6050->getRawAccZ();
+    raw[3] = this->mpu6050->getRawGyroX();
+    raw[4] = this->mpu6050->getRawGyroY();
+    raw[5] = this->mpu6050->getRawGyroZ();
+}
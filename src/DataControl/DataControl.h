@@ -26,6 +26,7 @@ public:
     void InitPeripheral();
     float GetRoll();
     float GetPitch();
+    void GetRawImu(int16_t *raw);
 
 private:
     void InitMpu();
@@ -19,7 +19,9 @@
 #include "MainState.h"
 #include "StateMachine.h"
 #include "Configure/Cfg.h"
+#include "Configure/Parameter.h"
 #include "DataControl/DataControl.h"
+#include "Communication/SerialCommand.h"
 
 /***********************************************************************************************************************
  **                                                   DEFINES/MACROS                                                  **
@@ -39,6 +41,7 @@ static void state_BlinkRight(void);
 static void state_TemporaryOff(void);
 
 static void ActiveLight(boolean status);
+static void NotifyState(uint8_t state);
 
 /* List of condition */
 bool IsInitDone();
@@ -63,6 +66,7 @@ State* S_TemporaryOff = machine.addState(&state_TemporaryOff);
 
 static long lastCheck;
 static int lastState;
+static uint8_t currentState = E_Unknown;
 
 /***********************************************************************************************************************
  **                                                FUNCTION DEFINITIONS                                               **
@@ -91,6 +95,11 @@ void StateMachine_RunOneStep()
     machine.run();
 }
 
+uint8_t StateMachine_GetState()
+{
+    return currentState;
+}
+
 /**
  ***********************************************************************************************************************
  * \brief Currently we using the low active relay so the logic will be revert. If change the relay, remember that you
@@ -123,7 +132,6 @@ bool IsTurnLeftSignal()
 {
     if (LOW == digitalRead(SIGNAL_LEFT_PIN))
     {
-        Serial.println("Turn left");
         lastCheck = millis();
         return true;
     }
@@ -137,7 +145,6 @@ bool IsTurnRightSignal()
 {
     if (LOW == digitalRead(SIGNAL_RIGHT_PIN))
     {
-        Serial.println("Turn right");
         lastCheck = millis();
         return true;
     }
@@ -149,7 +156,7 @@ bool IsTurnRightSignal()
 
 bool IsOutBoundOfRightAngle()
 {
-    if (dataController.GetPitch() > (float)TURN_ANGLE && lastState == E_TurnRight)
+    if (dataController.GetPitch() > Parameter_GetTurnAngle() && lastState == E_TurnRight)
     {
         lastCheck = millis();
         return true;
@@ -163,7 +170,7 @@ bool IsOutBoundOfRightAngle()
 
 bool IsOutBoundOfLeftAngle()
 {
-    if (dataController.GetPitch() < -(float)(TURN_ANGLE) && lastState == E_TurnLeft)
+    if (dataController.GetPitch() < -Parameter_GetTurnAngle() && lastState == E_TurnLeft)
     {
         lastCheck = millis();
         return true;
@@ -212,7 +219,7 @@ bool IsSwitchChangeState()
 bool IsBackToNormal()
 {
     long currentTime = millis();
-    if (currentTime - lastCheck > BACK_TO_NORMAL_TIME)
+    if ((unsigned long)(currentTime - lastCheck) > Parameter_GetBackToNormalTime())
     {
         return true;
     }
@@ -223,49 +230,52 @@ bool IsBackToNormal()
 /**********************************************************************************************************************/
 /* State */
 
-static void PrintOut_RollPitch()
+/**
+ ***********************************************************************************************************************
+ * \brief The state functions run on every step, only report to PC when the state really changes. A host that subscribes
+ *        later gets the current state from StateMachine_GetState().
+ **********************************************************************************************************************/
+static void NotifyState(uint8_t state)
 {
-    Serial.print(" - [");
-    Serial.print(dataController.GetRoll());
-    Serial.print("] - [");
-    Serial.print(dataController.GetPitch());
-    Serial.println("]");
+    if (state != currentState)
+    {
+        currentState = state;
+#ifdef MONITOR_DATA_TO_PC
+        SerialCommand_SendStateEvent(state);
+#endif
+    }
 }
 
 static void state_Init(void)
 {
-    Serial.println("Init state!");
+    NotifyState(E_Init);
     digitalWrite(LIGHT_CONTROL_PIN, LOW);
 }
 
 static void state_NormalOff(void)
 {
-    Serial.print("NormalOff state!");
-    PrintOut_RollPitch();
+    NotifyState(E_NormalOff);
     digitalWrite(LIGHT_CONTROL_PIN, LOW);
     lastState = E_NormalOff;
 }
 
 static void state_BlinkLeft(void)
 {
-    Serial.print("Blinking Left state!");
-    PrintOut_RollPitch();
+    NotifyState(E_TurnLeft);
     digitalWrite(LIGHT_CONTROL_PIN, HIGH);
     lastState = E_TurnLeft;
 }
 
 static void state_BlinkRight(void)
 {
-    Serial.print("Blinking Right state!");
-    PrintOut_RollPitch();
+    NotifyState(E_TurnRight);
     digitalWrite(LIGHT_CONTROL_PIN, HIGH);
     lastState = E_TurnRight;
 }
 
 static void state_TemporaryOff(void)
 {
-    Serial.print("TemporaryOff state!");
-    PrintOut_RollPitch();
+    NotifyState(E_TemporaryOff);
     digitalWrite(LIGHT_CONTROL_PIN, LOW);
     // lastState = E_TemporaryOff;
 }
@@ -14,14 +14,19 @@
 #ifndef __MAIN_STATE__
 #define __MAIN_STATE__
 
+#include <Arduino.h>
+
 enum {
     E_NormalOff,
     E_TurnRight,
     E_TurnLeft,
-    E_TemporaryOff
+    E_TemporaryOff,
+    E_Init,
+    E_Unknown = 0xFF
 };
 
 void StateMachine_Initialize();
 void StateMachine_RunOneStep();
+uint8_t StateMachine_GetState();
 
 #endif
@@ -19,6 +19,8 @@
 #include "Configure/Cfg.h"
 #include "DataControl/DataControl.h"
 #include "StateMachine/MainState.h"
+#include "Configure/Parameter.h"
+#include "Communication/SerialCommand.h"
 
 /***********************************************************************************************************************
  **                                                   DEFINES/MACROS                                                  **
@@ -49,7 +51,11 @@ static void ToggleAliveLed();
  **********************************************************************************************************************/
 void setup()
 {
+    Parameter_Initialize();
     dataController.InitPeripheral();
+#ifdef MONITOR_DATA_TO_PC
+    SerialCommand_Initialize();
+#endif
     StateMachine_Initialize();
 }
 
@@ -57,15 +63,29 @@ void setup()
  ***********************************************************************************************************************
  * \brief Main loop.
  * - Checking to running the state machine
+ * - Handle the commands from PC and send the subscribed streams
  * - Toggle the Alive led to inform state of system
  **********************************************************************************************************************/
 void loop()
 {
+#ifdef MONITOR_DATA_TO_PC
+    SerialCommand_ProcessRx();
+#endif
+
     if (millis() - timer > DELAY_TIME)
     {
+#ifdef MONITOR_DATA_TO_PC
+        unsigned long stepStart = micros();
+#endif
+
         dataController.UpdateAndProcessData();
         StateMachine_RunOneStep();
         timer = millis();
+
+#ifdef MONITOR_DATA_TO_PC
+        SerialCommand_UpdateProfiler(micros() - stepStart);
+        SerialCommand_PublishStreams();
+#endif
     }
 
     if (millis() - alive_led_timer > ALIVE_LED_TIME)